@@ -0,0 +1,679 @@
+#include "DistributedSolver.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iterator>
+#include <thread>
+#include <cerrno>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace
+{
+    // Amount of subproblems the coordinator creates per worker before handing them out
+    constexpr int SubproblemsPerWorker{ 8 };
+
+    // Workers split a received subproblem this many levels deep, giving up to 2^SplitDepth leaves
+    // that each get the recursive backtracking for everything below them.
+    // The unsolved leaves are what can be given back on a Split, the subproblems given back get split again by their new worker
+    constexpr int SplitDepth{ 6 };
+
+    // How long the coordinator waits for every worker to connect
+    constexpr auto ConnectTimeout{ std::chrono::seconds(10) };
+
+    // How often the coordinator wakes up without messages, to check on its workers
+    constexpr int PollIntervalMs{ 100 };
+
+    // Size of the biggest messages, for a 255x255 puzzle, anything bigger is a broken connection
+    // Puzzle: width and height, then per line a hint count and at most 128 hints
+    // Subproblem: position, then the grid and the impossible squares packed as bits
+    constexpr uint32_t MaxLineSize{ 255 };
+    constexpr uint32_t MaxPuzzleSize{ 2 + 2 * MaxLineSize * (1 + (MaxLineSize + 1) / 2) };
+    constexpr uint32_t MaxSubproblemSize{ 2 + 2 * ((MaxLineSize * MaxLineSize + 7) / 8) };
+    constexpr uint32_t MaxPayloadSize{ std::max(MaxPuzzleSize, MaxSubproblemSize) };
+
+    // Serialization
+
+    void WriteU8(std::vector<uint8_t>& payload, uint8_t value)
+    {
+        payload.push_back(value);
+    }
+
+    void WriteU16(std::vector<uint8_t>& payload, uint16_t value)
+    {
+        payload.push_back(uint8_t(value));
+        payload.push_back(uint8_t(value >> 8));
+    }
+
+    void WriteBits(std::vector<uint8_t>& payload, const std::vector<bool>& bits)
+    {
+        size_t offset{ payload.size() };
+        payload.resize(offset + (bits.size() + 7) / 8, 0);
+        for (size_t i{}; i < bits.size(); ++i)
+            if (bits[i]) payload[offset + i / 8] |= uint8_t(1 << (i % 8));
+    }
+
+    class PayloadReader
+    {
+    public:
+        PayloadReader(const std::vector<uint8_t>& payload) : m_Payload{ payload } {}
+
+        uint8_t ReadU8()
+        {
+            if (m_Offset >= m_Payload.size()) { m_IsValid = false; return 0; }
+            return m_Payload[m_Offset++];
+        }
+
+        uint16_t ReadU16()
+        {
+            uint16_t low{ ReadU8() };
+            return uint16_t(low | ReadU8() << 8);
+        }
+
+        std::vector<bool> ReadBits(size_t count)
+        {
+            std::vector<bool> bits(count, false);
+            if (m_Offset + (count + 7) / 8 > m_Payload.size()) { m_IsValid = false; return bits; }
+
+            for (size_t i{}; i < count; ++i)
+                bits[i] = m_Payload[m_Offset + i / 8] & (1 << (i % 8));
+            m_Offset += (count + 7) / 8;
+            return bits;
+        }
+
+        bool IsValid() const { return m_IsValid; }
+
+    private:
+        const std::vector<uint8_t>& m_Payload;
+        size_t m_Offset{};
+        bool m_IsValid{ true };
+    };
+
+    std::vector<uint8_t> EncodePuzzle(const Nonogram& puzzle)
+    {
+        std::vector<uint8_t> payload;
+        WriteU8(payload, uint8_t(puzzle.GetWidth()));
+        WriteU8(payload, uint8_t(puzzle.GetHeight()));
+
+        for (const auto* pHints : { &puzzle.GetHorizontalHints(), &puzzle.GetVerticalHints() })
+        {
+            for (const std::vector<int>& hints : *pHints)
+            {
+                WriteU8(payload, uint8_t(hints.size()));
+                for (int hint : hints)
+                    WriteU8(payload, uint8_t(hint));
+            }
+        }
+        return payload;
+    }
+
+    bool DecodePuzzle(const std::vector<uint8_t>& payload, Nonogram& puzzle)
+    {
+        PayloadReader reader{ payload };
+        int width{ reader.ReadU8() };
+        int height{ reader.ReadU8() };
+
+        std::vector<std::vector<int>> horizontalHints(height);
+        std::vector<std::vector<int>> verticalHints(width);
+        for (auto* pHints : { &horizontalHints, &verticalHints })
+        {
+            for (std::vector<int>& hints : *pHints)
+            {
+                hints.resize(reader.ReadU8());
+                for (int& hint : hints)
+                    hint = reader.ReadU8();
+            }
+        }
+
+        if (!reader.IsValid()) return false;
+
+        puzzle = Nonogram{ horizontalHints, verticalHints };
+        return true;
+    }
+
+    std::vector<uint8_t> EncodeSubproblem(const Subproblem& subproblem)
+    {
+        std::vector<uint8_t> payload;
+        WriteU16(payload, uint16_t(subproblem.position));
+        WriteBits(payload, subproblem.grid);
+        WriteBits(payload, subproblem.impossibleSquares);
+        return payload;
+    }
+
+    bool DecodeSubproblem(const std::vector<uint8_t>& payload, const Nonogram& puzzle, Subproblem& subproblem)
+    {
+        size_t size{ size_t(puzzle.GetWidth() * puzzle.GetHeight()) };
+
+        PayloadReader reader{ payload };
+        subproblem.position = reader.ReadU16();
+        subproblem.grid = reader.ReadBits(size);
+        subproblem.impossibleSquares = reader.ReadBits(size);
+
+        return reader.IsValid() && size_t(subproblem.position) <= size;
+    }
+
+    // Socket IO
+
+    bool WriteAll(int socket, const uint8_t* pData, size_t size)
+    {
+        while (size > 0)
+        {
+            ssize_t written{ send(socket, pData, size, MSG_NOSIGNAL) };
+            if (written < 0 && errno == EINTR) continue;
+            if (written <= 0) return false;
+
+            pData += written;
+            size -= size_t(written);
+        }
+        return true;
+    }
+
+    bool ReadAll(int socket, uint8_t* pData, size_t size)
+    {
+        while (size > 0)
+        {
+            ssize_t received{ recv(socket, pData, size, 0) };
+            if (received < 0 && errno == EINTR) continue;
+            if (received <= 0) return false;
+
+            pData += received;
+            size -= size_t(received);
+        }
+        return true;
+    }
+
+    bool SendMessage(int socket, DistributedMessage type, const std::vector<uint8_t>& payload = {})
+    {
+        std::vector<uint8_t> message;
+        message.reserve(5 + payload.size());
+        WriteU8(message, uint8_t(type));
+        for (int i = 0; i < 4; ++i)
+            WriteU8(message, uint8_t(payload.size() >> (8 * i)));
+        message.insert(message.end(), payload.begin(), payload.end());
+
+        return WriteAll(socket, message.data(), message.size());
+    }
+
+    bool ReceiveMessage(int socket, DistributedMessage& type, std::vector<uint8_t>& payload)
+    {
+        uint8_t header[5]{};
+        if (!ReadAll(socket, header, sizeof(header))) return false;
+
+        uint32_t size{};
+        for (int i = 0; i < 4; ++i)
+            size |= uint32_t(header[1 + i]) << (8 * i);
+        if (header[0] > uint8_t(DistributedMessage::Shutdown) || size > MaxPayloadSize) return false;
+
+        type = DistributedMessage(header[0]);
+        payload.resize(size);
+        return ReadAll(socket, payload.data(), size);
+    }
+
+    // Only a process with a single thread can fork and keep running normal code in the child
+    bool IsSingleThreaded()
+    {
+        std::error_code error;
+        std::filesystem::directory_iterator tasks{ "/proc/self/task", error };
+        return !error && std::distance(tasks, std::filesystem::directory_iterator{}) == 1;
+    }
+
+    // Returns false if the path doesn't fit, a truncated path would bind a different file than the one unlinked
+    bool MakeAddress(const std::string& socketPath, sockaddr_un& address)
+    {
+        address = sockaddr_un{};
+        address.sun_family = AF_UNIX;
+        if (socketPath.empty() || socketPath.size() >= sizeof(address.sun_path)) return false;
+
+        socketPath.copy(address.sun_path, socketPath.size());
+        return true;
+    }
+}
+
+bool SplitSubproblem(Nonogram& nonogram, const Subproblem& subproblem, std::vector<Subproblem>& children)
+{
+    nonogram.SetSolverState(subproblem.grid, subproblem.impossibleSquares);
+
+    int position{ nonogram.GetNextUndecidedSquare(subproblem.position) };
+    if (position == nonogram.GetWidth() * nonogram.GetHeight()) return false;
+
+    // filled first, the same order the recursive backtracking tries them in
+    for (bool value : { true, false })
+    {
+        nonogram.SetSolverState(subproblem.grid, subproblem.impossibleSquares);
+        if (nonogram.DecideSquare(subproblem.position, position, value))
+            children.push_back(Subproblem{ position + 1, nonogram.getGrid(), nonogram.getImpossibleGrid(), subproblem.depth + 1 });
+    }
+    return true;
+}
+
+DistributedCoordinator::DistributedCoordinator(const std::string& socketPath, int workerCount)
+    : m_SocketPath  { socketPath }
+    , m_WorkerCount { std::max(1, workerCount) }
+{
+}
+
+DistributedResult DistributedCoordinator::Solve(Nonogram& nonogram, bool spawnWorkers)
+{
+    m_Puzzle = nonogram;
+    m_Puzzle.PrepareFreeSquares();
+
+    m_Queue = { Subproblem{ 0, m_Puzzle.getGrid(), m_Puzzle.getImpossibleGrid() } };
+    m_Workers.clear();
+    m_IsSolved = false;
+
+    // Split the search tree breadth first until every worker can get a couple of subproblems
+    Nonogram splitNonogram{ m_Puzzle };
+    for (size_t i{}; i < m_Queue.size() && m_Queue.size() < size_t(m_WorkerCount * SubproblemsPerWorker);)
+    {
+        std::vector<Subproblem> children;
+        if (!SplitSubproblem(splitNonogram, m_Queue[i], children))
+        {
+            ++i; // every square is decided, leave it for a worker to check
+            continue;
+        }
+        m_Queue.erase(m_Queue.begin() + i);
+        m_Queue.insert(m_Queue.end(), children.begin(), children.end());
+    }
+
+    sockaddr_un address{};
+    if (!MakeAddress(m_SocketPath, address)) return DistributedResult::InvalidSocketPath;
+
+    // The forked workers create threads and allocate, which is undefined after forking a multithreaded process
+    if (spawnWorkers && !IsSingleThreaded()) return DistributedResult::MultithreadedCaller;
+
+    int listenSocket{ socket(AF_UNIX, SOCK_STREAM, 0) };
+    if (listenSocket < 0) return DistributedResult::SocketError;
+
+    unlink(m_SocketPath.c_str());
+    if (bind(listenSocket, (sockaddr*)&address, sizeof(address)) < 0 || listen(listenSocket, m_WorkerCount) < 0)
+    {
+        close(listenSocket);
+        return DistributedResult::SocketError;
+    }
+
+    std::vector<pid_t> children;
+    if (spawnWorkers)
+    {
+        for (int i = 0; i < m_WorkerCount; ++i)
+        {
+            pid_t pid{ fork() };
+            if (pid == 0)
+            {
+                close(listenSocket);
+                DistributedWorker{ m_SocketPath }.Run();
+                _exit(0);
+            }
+            if (pid < 0) break;
+            children.push_back(pid);
+        }
+    }
+    m_ExpectedWorkerCount = spawnWorkers ? int(children.size()) : m_WorkerCount;
+
+    // Stays Unsolvable until something goes wrong, a lost worker took its part of the search tree with it
+    // so the search stops without an answer
+    DistributedResult result{ m_ExpectedWorkerCount == 0 ? DistributedResult::SpawnFailed : DistributedResult::Unsolvable };
+    auto connectDeadline{ std::chrono::steady_clock::now() + ConnectTimeout };
+    while (!m_IsSolved && result == DistributedResult::Unsolvable && !IsExhausted())
+    {
+        // Stop listening once every worker is connected, a connection that stays pending would keep waking up poll
+        bool isListening{ int(m_Workers.size()) < m_ExpectedWorkerCount };
+        std::vector<pollfd> pollSockets{ pollfd{ isListening ? listenSocket : -1, POLLIN, 0 } };
+        for (const WorkerConnection& worker : m_Workers)
+            pollSockets.push_back(pollfd{ worker.socket, POLLIN, 0 });
+
+        int readyCount{ poll(pollSockets.data(), nfds_t(pollSockets.size()), PollIntervalMs) };
+        if (readyCount < 0)
+        {
+            if (errno == EINTR) continue;
+            result = DistributedResult::SocketError;
+            break;
+        }
+
+        for (size_t i{ 1 }; i < pollSockets.size() && result == DistributedResult::Unsolvable; ++i)
+        {
+            if (pollSockets[i].revents & (POLLIN | POLLHUP | POLLERR) && !HandleMessage(m_Workers[i - 1]))
+                result = DistributedResult::ConnectionLost;
+        }
+
+        if (pollSockets[0].revents & POLLIN)
+        {
+            int workerSocket{ accept(listenSocket, nullptr, nullptr) };
+            if (workerSocket >= 0)
+            {
+                m_Workers.push_back(WorkerConnection{ workerSocket });
+                if (!SendMessage(workerSocket, DistributedMessage::Puzzle, EncodePuzzle(m_Puzzle)))
+                    result = DistributedResult::ConnectionLost;
+            }
+        }
+
+        // Spawned workers only exit after a Shutdown, one that exits earlier is lost, connected or not
+        for (auto it = children.begin(); it != children.end();)
+        {
+            if (waitpid(*it, nullptr, WNOHANG) == *it)
+            {
+                it = children.erase(it);
+                result = DistributedResult::ConnectionLost;
+            }
+            else ++it;
+        }
+
+        // Carry on with the workers that made it in time, without any there is nobody to solve it
+        if (isListening && std::chrono::steady_clock::now() > connectDeadline)
+        {
+            m_ExpectedWorkerCount = int(m_Workers.size());
+            if (m_ExpectedWorkerCount == 0) result = DistributedResult::ConnectTimeout;
+        }
+
+        // Workers that had nothing to give back have moved on since, ask them again
+        if (readyCount == 0)
+        {
+            RetrySplits();
+            Dispatch();
+        }
+    }
+
+    if (m_IsSolved) Broadcast(DistributedMessage::Cancel);
+    Broadcast(DistributedMessage::Shutdown);
+
+    for (const WorkerConnection& worker : m_Workers)
+        close(worker.socket);
+    m_Workers.clear();
+    close(listenSocket);
+    unlink(m_SocketPath.c_str());
+
+    for (pid_t pid : children)
+        waitpid(pid, nullptr, 0);
+
+    if (!m_IsSolved) return result;
+
+    nonogram.SetSolverState(m_Solution, m_Puzzle.getImpossibleGrid());
+    return DistributedResult::Solved;
+}
+
+void DistributedCoordinator::Dispatch()
+{
+    for (WorkerConnection& worker : m_Workers)
+    {
+        if (worker.state != WorkerState::Idle || m_Queue.empty()) continue;
+
+        // Shallow subproblems are at the front, those are the biggest ones
+        SendMessage(worker.socket, DistributedMessage::Subproblem, EncodeSubproblem(m_Queue.front()));
+        m_Queue.pop_front();
+        worker.state = WorkerState::Busy;
+        worker.hasNothingToSplit = false;
+    }
+
+    if (!m_Queue.empty()) return;
+
+    // Ask one busy worker to split for every idle worker that isn't already waiting on one
+    int idleCount{};
+    for (const WorkerConnection& worker : m_Workers)
+    {
+        if (worker.state == WorkerState::Idle) ++idleCount;
+        if (worker.isSplitPending) --idleCount;
+    }
+
+    for (WorkerConnection& worker : m_Workers)
+    {
+        if (idleCount <= 0) break;
+        if (worker.state != WorkerState::Busy || worker.isSplitPending || worker.hasNothingToSplit) continue;
+
+        SendMessage(worker.socket, DistributedMessage::Split);
+        worker.isSplitPending = true;
+        worker.donatedCount = 0;
+        --idleCount;
+    }
+}
+
+bool DistributedCoordinator::HandleMessage(WorkerConnection& worker)
+{
+    DistributedMessage type{};
+    std::vector<uint8_t> payload;
+    if (!ReceiveMessage(worker.socket, type, payload)) return false;
+
+    switch (type)
+    {
+    case DistributedMessage::RequestWork:
+        worker.state = WorkerState::Idle;
+        RetrySplits();
+        Dispatch();
+        break;
+
+    case DistributedMessage::Subproblem:
+    {
+        Subproblem subproblem;
+        if (!DecodeSubproblem(payload, m_Puzzle, subproblem)) return false;
+        m_Queue.push_back(std::move(subproblem));
+        ++worker.donatedCount;
+        break;
+    }
+
+    case DistributedMessage::SplitDone:
+        worker.isSplitPending = false;
+        // a worker that gave nothing back is on its last leaf, asking again right away would only bounce
+        worker.hasNothingToSplit = worker.donatedCount == 0;
+        Dispatch();
+        break;
+
+    case DistributedMessage::Solution:
+    {
+        PayloadReader reader{ payload };
+        m_Solution = reader.ReadBits(size_t(m_Puzzle.GetWidth() * m_Puzzle.GetHeight()));
+        if (!reader.IsValid()) return false;
+        m_IsSolved = true;
+        break;
+    }
+
+    default:
+        return false;
+    }
+    return true;
+}
+
+void DistributedCoordinator::RetrySplits()
+{
+    for (WorkerConnection& worker : m_Workers)
+        worker.hasNothingToSplit = false;
+}
+
+bool DistributedCoordinator::IsExhausted() const
+{
+    if (!m_Queue.empty() || int(m_Workers.size()) < m_ExpectedWorkerCount) return false;
+
+    return std::all_of(m_Workers.begin(), m_Workers.end(), [](const WorkerConnection& worker)
+        {
+            return worker.state == WorkerState::Idle && !worker.isSplitPending;
+        });
+}
+
+void DistributedCoordinator::Broadcast(DistributedMessage type)
+{
+    for (const WorkerConnection& worker : m_Workers)
+        SendMessage(worker.socket, type);
+}
+
+DistributedWorker::DistributedWorker(const std::string& socketPath)
+    : m_SocketPath{ socketPath }
+{
+}
+
+void DistributedWorker::Run()
+{
+    sockaddr_un address{};
+    if (!MakeAddress(m_SocketPath, address)) return;
+
+    // The coordinator might not be listening yet when the worker is started separately
+    for (int attempt = 0; attempt < 50; ++attempt)
+    {
+        m_Socket = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (m_Socket < 0) return;
+        if (connect(m_Socket, (sockaddr*)&address, sizeof(address)) == 0) break;
+
+        close(m_Socket);
+        m_Socket = -1;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    if (m_Socket < 0) return;
+
+    std::thread reader{ &DistributedWorker::ReadMessages, this };
+    SolveSubproblems();
+    reader.join();
+
+    close(m_Socket);
+    m_Socket = -1;
+}
+
+void DistributedWorker::ReadMessages()
+{
+    DistributedMessage type{};
+    std::vector<uint8_t> payload;
+
+    while (ReceiveMessage(m_Socket, type, payload) && type != DistributedMessage::Shutdown)
+    {
+        std::lock_guard<std::mutex> lock{ m_Mutex };
+        switch (type)
+        {
+        case DistributedMessage::Puzzle:
+            if (!DecodePuzzle(payload, m_Puzzle)) break;
+            ++m_PuzzleCount;
+            m_Pending.clear();
+            {
+                std::lock_guard<std::mutex> sendLock{ m_SendMutex };
+                SendMessage(m_Socket, DistributedMessage::RequestWork);
+            }
+            break;
+
+        case DistributedMessage::Subproblem:
+        {
+            Subproblem subproblem;
+            if (!DecodeSubproblem(payload, m_Puzzle, subproblem)) break;
+            m_Pending.push_back(std::move(subproblem));
+            m_Condition.notify_one();
+            break;
+        }
+
+        case DistributedMessage::Split:
+            DonateSubproblems();
+            break;
+
+        case DistributedMessage::Cancel:
+            m_Pending.clear();
+            m_IsCancelled = true;
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    // Shut down, either on request or because the coordinator is gone
+    std::lock_guard<std::mutex> lock{ m_Mutex };
+    m_IsShutdown = true;
+    m_Pending.clear();
+    m_IsCancelled = true;
+    m_Condition.notify_one();
+}
+
+void DistributedWorker::SolveSubproblems()
+{
+    // Copy of the puzzle the solver thread splits and solves on, so the hints aren't copied for every subproblem
+    Nonogram nonogram{ 0, 0 };
+    int puzzleCount{};
+
+    std::unique_lock<std::mutex> lock{ m_Mutex };
+    while (true)
+    {
+        m_Condition.wait(lock, [this] { return m_IsShutdown || !m_Pending.empty(); });
+        if (m_IsShutdown) return;
+
+        // Depth first: the deepest subproblem is at the back, the biggest ones stay at the front to be given back
+        Subproblem subproblem{ std::move(m_Pending.back()) };
+        m_Pending.pop_back();
+
+        // a Cancel clears the pending subproblems, so anything still pending came in after it
+        m_IsCancelled = false;
+
+        if (puzzleCount != m_PuzzleCount)
+        {
+            nonogram = m_Puzzle;
+            puzzleCount = m_PuzzleCount;
+        }
+
+        std::vector<Subproblem> children;
+        if (subproblem.depth < SplitDepth && SplitSubproblem(nonogram, subproblem, children))
+        {
+            // push the empty branch first so the filled branch gets solved first
+            for (auto it = children.rbegin(); it != children.rend(); ++it)
+                m_Pending.push_back(std::move(*it));
+        }
+        else
+        {
+            nonogram.SetSolverState(subproblem.grid, subproblem.impossibleSquares);
+            nonogram.SetCancelFlag(&m_IsCancelled);
+            m_IsSolvingLeaf = true;
+
+            lock.unlock();
+            bool isSolved{ nonogram.SolveFromPosition(subproblem.position) && !m_IsCancelled };
+            lock.lock();
+
+            m_IsSolvingLeaf = false;
+
+            if (isSolved)
+            {
+                std::vector<uint8_t> payload;
+                WriteBits(payload, nonogram.getGrid());
+
+                std::lock_guard<std::mutex> sendLock{ m_SendMutex };
+                SendMessage(m_Socket, DistributedMessage::Solution, payload);
+            }
+        }
+
+        if (m_Pending.empty())
+        {
+            std::lock_guard<std::mutex> sendLock{ m_SendMutex };
+            SendMessage(m_Socket, DistributedMessage::RequestWork);
+        }
+    }
+}
+
+void DistributedWorker::DonateSubproblems()
+{
+    std::lock_guard<std::mutex> sendLock{ m_SendMutex };
+
+    // Without an active subproblem the solver thread still has to pick up the last one,
+    // otherwise it would never notice it ran out of work and ask for more
+    size_t donateCount{ m_IsSolvingLeaf ? (m_Pending.size() + 1) / 2 : m_Pending.size() / 2 };
+
+    // The solver thread hasn't picked up its only subproblem yet,
+    // split it here so there is something to give back
+    if (!m_IsSolvingLeaf && m_Pending.size() == 1)
+    {
+        Nonogram nonogram{ m_Puzzle };
+        Subproblem& subproblem{ m_Pending.front() };
+
+        while (true)
+        {
+            std::vector<Subproblem> children;
+            if (!SplitSubproblem(nonogram, subproblem, children) || children.empty()) break;
+
+            // keep the filled branch and give back the empty one,
+            // when only one branch is still valid it replaces the subproblem and gets split further, regardless of its depth
+            bool hasBothBranches{ children.size() == 2 };
+            if (hasBothBranches)
+                SendMessage(m_Socket, DistributedMessage::Subproblem, EncodeSubproblem(children.back()));
+
+            subproblem = std::move(children.front());
+            if (hasBothBranches) break;
+        }
+    }
+
+    for (; donateCount > 0; --donateCount)
+    {
+        SendMessage(m_Socket, DistributedMessage::Subproblem, EncodeSubproblem(m_Pending.front()));
+        m_Pending.pop_front();
+    }
+    SendMessage(m_Socket, DistributedMessage::SplitDone);
+}
@@ -0,0 +1,152 @@
+#pragma once
+#include "Nonogram.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Coordinator/worker mode that spreads the recursive backtracking over several processes.
+//
+// The coordinator splits the search tree into subproblems (a partial grid plus the decision prefix)
+// and hands them out to workers over a stream socket. When a worker runs out of work the coordinator
+// asks the busy workers to split their remaining work, and once a solution is found every worker is cancelled.
+//
+// Only unix domain sockets (one Linux machine) are implemented for now, but every message is length prefixed
+// and little endian so the same protocol can be carried over TCP between several machines.
+//
+// Every message is [type: u8][payload size: u32][payload]
+//  coordinator -> worker: Puzzle, Subproblem, Split, Cancel, Shutdown
+//  worker -> coordinator: RequestWork, Subproblem (work given back after a Split), SplitDone, Solution
+
+enum class DistributedMessage : uint8_t
+{
+    Puzzle,         // u8 width, u8 height, per row and then per column: u8 hint count, u8 hints
+    Subproblem,     // u16 position, packed grid, packed impossible squares
+    Split,          // give back part of the remaining work
+    SplitDone,      // every subproblem given back after a Split has been sent
+    RequestWork,    // the worker has nothing left to do
+    Solution,       // packed grid
+    Cancel,         // stop the current work, a solution has been found
+    Shutdown        // close the connection
+};
+
+// Outcome of DistributedCoordinator::Solve, only Unsolvable means the puzzle has no solution,
+// the others mean the search couldn't be finished and can be retried
+enum class DistributedResult
+{
+    Solved,                 // the grid of the nonogram holds the solution
+    Unsolvable,             // the whole search tree was searched without finding a solution
+    InvalidSocketPath,      // empty or too long for a unix domain socket
+    MultithreadedCaller,    // spawnWorkers was set from a process with more than one thread
+    SocketError,            // creating, binding or polling the socket failed
+    SpawnFailed,            // not a single worker could be forked
+    ConnectTimeout,         // no worker connected before the connect timeout
+    ConnectionLost          // a worker disconnected or exited, its part of the search tree is lost
+};
+
+// A node of the search tree, every square before position has already been decided
+struct Subproblem
+{
+    int position{};
+    std::vector<bool> grid;
+    std::vector<bool> impossibleSquares;
+    int depth{}; // splits since the worker received it, not sent over the socket
+};
+
+class DistributedCoordinator
+{
+public:
+
+    DistributedCoordinator(const std::string& socketPath, int workerCount);
+
+    // Solve the nonogram by handing out subproblems to the workers
+    // When spawnWorkers is set the worker processes are forked by the coordinator itself,
+    // otherwise workerCount workers that are started separately are expected to connect
+    // Workers get 10 seconds to connect, after that the search carries on with the ones that did,
+    // or returns ConnectTimeout when none did
+    // Forking is only done from a single threaded process, from a multithreaded one (like the visual app)
+    // it returns MultithreadedCaller right away: start the workers separately and pass spawnWorkers = false instead
+    // Returns Solved and fills in the grid of the nonogram when a solution was found
+    DistributedResult Solve(Nonogram& nonogram, bool spawnWorkers = true);
+
+private:
+
+    enum class WorkerState { Connecting, Busy, Idle };
+
+    struct WorkerConnection
+    {
+        int socket{ -1 };
+        WorkerState state{ WorkerState::Connecting };
+        bool isSplitPending{};
+        bool hasNothingToSplit{}; // answered the last Split without work, not asked again until RetrySplits
+        int donatedCount{}; // subproblems given back since the last Split
+    };
+
+    // Send out queued subproblems to idle workers, or ask busy workers to split when the queue is empty
+    void Dispatch();
+
+    // Allow asking workers that had nothing to give back for a Split again
+    void RetrySplits();
+
+    // Returns false if the worker disconnected
+    bool HandleMessage(WorkerConnection& worker);
+
+    bool IsExhausted() const;
+
+    void Broadcast(DistributedMessage type);
+
+    std::string m_SocketPath;
+    int m_WorkerCount;
+    int m_ExpectedWorkerCount{}; // workers that are still expected to connect, lowered when spawning or connecting fails
+
+    Nonogram m_Puzzle{ 0, 0 };
+    std::deque<Subproblem> m_Queue;
+    std::vector<WorkerConnection> m_Workers;
+
+    bool m_IsSolved{};
+    std::vector<bool> m_Solution;
+};
+
+class DistributedWorker
+{
+public:
+
+    DistributedWorker(const std::string& socketPath);
+
+    // Connect to the coordinator and solve subproblems until it shuts the worker down
+    void Run();
+
+private:
+
+    // Reader thread: handles messages from the coordinator while the solver runs
+    void ReadMessages();
+
+    // Solver thread: splits received subproblems a few levels deep, depth first, and solves those leaves with the recursive backtracking
+    void SolveSubproblems();
+
+    // Give back half of the pending subproblems, starting with the biggest ones
+    void DonateSubproblems();
+
+    std::string m_SocketPath;
+    int m_Socket{ -1 };
+
+    std::mutex m_SendMutex;
+
+    std::mutex m_Mutex; // guards everything below
+    std::condition_variable m_Condition;
+    Nonogram m_Puzzle{ 0, 0 };
+    int m_PuzzleCount{}; // amount of puzzles received, the solver thread copies the puzzle when it changes
+    std::deque<Subproblem> m_Pending;
+    bool m_IsSolvingLeaf{}; // the solver thread is running the recursive backtracking without holding the mutex
+    bool m_IsShutdown{};
+
+    // Checked by the recursive backtracking of the solver thread, set by the reader thread on Cancel and Shutdown
+    std::atomic<bool> m_IsCancelled{};
+};
+
+// Split the subproblem on its next undecided square, nonogram holds the hints and its grid gets overwritten
+// Returns false if every square is already decided, children only contains the branches that are still valid
+bool SplitSubproblem(Nonogram& nonogram, const Subproblem& subproblem, std::vector<Subproblem>& children);
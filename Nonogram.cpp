@@ -1,4 +1,6 @@
 ﻿#include "Nonogram.h"
+#include <algorithm>
+#include <filesystem>
 #include <fstream>
 
 Nonogram::Nonogram(const std::initializer_list<std::initializer_list<int>>& horizontalHints, std::initializer_list<std::initializer_list<int>> verticalHints)
@@ -17,7 +19,7 @@ Nonogram::Nonogram(const std::initializer_list<std::initializer_list<int>>& hori
     m_ImpossibleSquares = m_Grid = std::vector<bool>(m_Width * m_Height, false);
 }
 
-inline Nonogram::Nonogram(const std::vector<bool>& grid, int width, int height)
+Nonogram::Nonogram(const std::vector<bool>& grid, int width, int height)
     : m_Width   { uint8_t(width) }
     , m_Height  { uint8_t(height) }
     , m_Grid    { grid }
@@ -34,18 +36,32 @@ Nonogram::Nonogram(int width, int height)
     GenerateHints();
 }
 
+Nonogram::Nonogram(const std::vector<std::vector<int>>& horizontalHints, const std::vector<std::vector<int>>& verticalHints)
+    : m_HorizontalHints { horizontalHints }
+    , m_VerticalHints   { verticalHints }
+    , m_Width           { uint8_t(verticalHints.size()) }
+    , m_Height          { uint8_t(horizontalHints.size()) }
+{
+    m_ImpossibleSquares = m_Grid = std::vector<bool>(m_Width * m_Height, false);
+}
+
 Nonogram::Nonogram(const std::wstring& filePath)
 {
     std::ifstream ifStream;
     try {
-        ifStream.open(filePath, std::ios::binary);
+        ifStream.open(std::filesystem::path{ filePath }, std::ios::binary);
 
-        ifStream >> m_Width;
-        ifStream >> m_Height;
+        // read the sizes as raw bytes, >> would skip sizes that happen to be whitespace characters
+        ifStream.read((char*)&m_Width, 1);
+        ifStream.read((char*)&m_Height, 1);
 
         m_Grid = std::vector<bool>(m_Width * m_Height, false);
 
-        ifStream.read((char*)m_Grid._Myvec.data(), m_Grid._Myvec.size() * sizeof(m_Grid._Myvec.data()));
+        // the squares are stored as little endian 32 bit words, the first square in the lowest bit
+        std::vector<unsigned char> bytes(GetGridFileSize(m_Grid.size()), 0);
+        ifStream.read((char*)bytes.data(), bytes.size());
+        for (size_t i{}; i < m_Grid.size(); ++i)
+            m_Grid[i] = bytes[i / 8] & (1 << (i % 8));
 
         m_ImpossibleSquares = std::vector<bool>(m_Width * m_Height, false);
 
@@ -58,6 +74,11 @@ Nonogram::Nonogram(const std::wstring& filePath)
     ifStream.close();
 }
 
+size_t Nonogram::GetGridFileSize(size_t squareCount)
+{
+    return (squareCount + 31) / 32 * 4;
+}
+
 void Nonogram::GenerateHints()
 {
     if (m_IsLocked) return;
@@ -93,10 +114,14 @@ void Nonogram::SaveToFile(const std::wstring& filename) const
     if (m_IsLocked) return;
 
     std::ofstream ofStream;
-    ofStream.open(filename, std::ios::binary);
-    ofStream << m_Width;
-    ofStream << m_Height;
-    ofStream.write((char*)m_Grid._Myvec.data(), m_Grid._Myvec.size() * sizeof(m_Grid._Myvec.data()));
+    ofStream.open(std::filesystem::path{ filename }, std::ios::binary);
+    ofStream.write((const char*)&m_Width, 1);
+    ofStream.write((const char*)&m_Height, 1);
+
+    std::vector<unsigned char> bytes(GetGridFileSize(m_Grid.size()), 0);
+    for (size_t i{}; i < m_Grid.size(); ++i)
+        if (m_Grid[i]) bytes[i / 8] |= 1 << (i % 8);
+    ofStream.write((const char*)bytes.data(), bytes.size());
 
     ofStream.close();
 }
@@ -211,6 +236,60 @@ void Nonogram::SolveImprovedRecursiveBacktracking()
     m_IsLocked = false;
 }
 
+void Nonogram::SetSolverState(const std::vector<bool>& grid, const std::vector<bool>& impossibleSquares)
+{
+    if (m_IsLocked) return;
+
+    m_Grid = grid;
+    m_ImpossibleSquares = impossibleSquares;
+}
+
+void Nonogram::PrepareFreeSquares()
+{
+    if (m_IsLocked) return;
+
+    ClearGrid();
+
+    FillFreeSquares();
+}
+
+int Nonogram::GetNextUndecidedSquare(int position) const
+{
+    int size{ m_Width * m_Height };
+    while (position < size && (m_Grid[position] || m_ImpossibleSquares[position]))
+        ++position;
+
+    return position;
+}
+
+bool Nonogram::DecideSquare(int fromPosition, int position, bool value)
+{
+    if (m_IsLocked) return false;
+
+    m_Grid[position] = value;
+    m_ImpossibleSquares[position] = !value;
+
+    // squares before position may have been filled in by FillFreeSquares and were never checked
+    for (int i = fromPosition; i <= position; ++i)
+    {
+        if (!CheckIfValidSquare(i % m_Width, i / m_Width))
+            return false;
+    }
+    return true;
+}
+
+bool Nonogram::SolveFromPosition(int position)
+{
+    if (m_IsLocked) return false;
+
+    m_IsLocked = true;
+
+    bool isSolved{ SetNextValueRecursion(position, true) || SetNextValueRecursion(position, false) };
+
+    m_IsLocked = false;
+
+    return isSolved;
+}
 
 bool Nonogram::CheckIfValidSquare(int xPos, int yPos)
 {
@@ -314,6 +393,7 @@ bool Nonogram::CheckIfValidSquare(int xPos, int yPos)
 bool Nonogram::SetNextValueRecursion(int position, bool value)
 {
     if (!m_IsLocked) return false;
+    if (m_pCancelFlag && m_pCancelFlag->load(std::memory_order_relaxed)) return false;
 
     //if final position + 1: return true
     if (position == m_Width * m_Height)
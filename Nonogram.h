@@ -1,4 +1,6 @@
 #pragma once
+#include <atomic>
+#include <cstdint>
 #include <vector>
 #include <string>
 
@@ -9,6 +11,7 @@ public:
     Nonogram(const std::initializer_list<std::initializer_list<int>>& horizontalHints, std::initializer_list<std::initializer_list<int>> verticalHints);
     Nonogram(const std::vector<bool>& grid, int width, int height);
     Nonogram(int width, int height);
+    Nonogram(const std::vector<std::vector<int>>& horizontalHints, const std::vector<std::vector<int>>& verticalHints);
     Nonogram(const std::wstring& filePath);
     ~Nonogram() = default;
 
@@ -45,6 +48,9 @@ private:
     void UpdateHintColumn(int x);
     void UpdateHintRow(int y);
 
+    // Size in bytes of the squares in a saved file, they are stored in whole 32 bit words
+    static size_t GetGridFileSize(size_t squareCount);
+
     std::vector<bool> m_Grid;
     std::vector<std::vector<int>> m_HorizontalHints;
     std::vector<std::vector<int>> m_VerticalHints;
@@ -52,6 +58,7 @@ private:
     uint8_t m_Width;
     uint8_t m_Height;
     bool m_IsLocked = false; // no changes can be made when locked
+    const std::atomic<bool>* m_pCancelFlag{}; // stops the solver when set, see SetCancelFlag
 
 public: // Solvers
 
@@ -61,6 +68,31 @@ public: // Solvers
     // Reset and solve the nonogram by first filling in guarantied squares and then applying recursive backtracking
     void SolveImprovedRecursiveBacktracking();
 
+public: // Search tree helpers, used by the distributed solver to hand out parts of the search tree
+
+    // Replace the grid and the impossible squares, used to restore a subproblem
+    void SetSolverState(const std::vector<bool>& grid, const std::vector<bool>& impossibleSquares);
+
+    // Clear the grid and fill in the free squares without starting a solver
+    void PrepareFreeSquares();
+
+    // Returns the first square from position onwards that is neither filled nor impossible
+    // Returns width * height if every remaining square is already decided
+    int GetNextUndecidedSquare(int position) const;
+
+    // Decide the square at position (filled, or impossible when value is false)
+    // and check every square from fromPosition up to it against the hints
+    // Returns false if the board can no longer be solved
+    bool DecideSquare(int fromPosition, int position, bool value);
+
+    // The recursive backtracking stops as soon as this flag is set, it can be set from any thread
+    // Unlike Unlock() this doesn't touch the lock, which is only safe to change from the solving thread
+    void SetCancelFlag(const std::atomic<bool>* pCancelFlag) { m_pCancelFlag = pCancelFlag; }
+
+    // Continue the recursive backtracking from position, all squares before it are kept as they are
+    // Returns true if a solution was found, false if there is none or the solver was cancelled
+    bool SolveFromPosition(int position);
+
 private: // Solver Helpers
 
     // Squares that have to be empty
@@ -0,0 +1,183 @@
+#include "SolutionVerifier.h"
+#include <algorithm>
+#include <thread>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace
+{
+    int CountTrailingZeros(uint64_t value)
+    {
+#ifdef _MSC_VER
+        unsigned long index{};
+        _BitScanForward64(&index, value);
+        return int(index);
+#else
+        return __builtin_ctzll(value);
+#endif
+    }
+
+    // Transpose the Size x Size bit matrix in the low bits of the first Size words in place,
+    // afterwards bit y of word x is what bit x of word y was.
+    // Swaps the off diagonal blocks of half the size, then the blocks inside those and so on
+    template<int Size>
+    void Transpose(uint64_t* pMatrix)
+    {
+        uint64_t mask{ (1ull << (Size / 2)) - 1 };
+        for (int blockSize = Size / 2; blockSize != 0; blockSize >>= 1, mask ^= mask << blockSize)
+        {
+            for (int blockStart = 0; blockStart < Size; blockStart += 2 * blockSize)
+            {
+                for (int k = blockStart; k < blockStart + blockSize; ++k)
+                {
+                    uint64_t swapBits{ ((pMatrix[k] >> blockSize) ^ pMatrix[k + blockSize]) & mask };
+                    pMatrix[k] ^= swapBits << blockSize;
+                    pMatrix[k + blockSize] ^= swapBits;
+                }
+            }
+        }
+    }
+
+    // Only transpose as much as needed, 30x30 grids fit in a 32x32 matrix
+    void Transpose(uint64_t* pMatrix, int size)
+    {
+        switch (size)
+        {
+        case 1:                             break;
+        case 2:  Transpose<2>(pMatrix);     break;
+        case 4:  Transpose<4>(pMatrix);     break;
+        case 8:  Transpose<8>(pMatrix);     break;
+        case 16: Transpose<16>(pMatrix);    break;
+        case 32: Transpose<32>(pMatrix);    break;
+        default: Transpose<64>(pMatrix);    break;
+        }
+    }
+}
+
+SolutionVerifier::SolutionVerifier(const Nonogram& nonogram)
+    : SolutionVerifier(nonogram.GetHorizontalHints(), nonogram.GetVerticalHints())
+{
+}
+
+SolutionVerifier::SolutionVerifier(const std::vector<std::vector<int>>& horizontalHints, const std::vector<std::vector<int>>& verticalHints)
+    : m_Width   { int(verticalHints.size()) }
+    , m_Height  { int(horizontalHints.size()) }
+{
+    m_IsValid = m_Width <= MaxSize && m_Height <= MaxSize;
+    if (!m_IsValid) return;
+
+    m_RowMask = m_Width == 64 ? ~0ull : (1ull << m_Width) - 1;
+
+    m_TransposeSize = 1;
+    while (m_TransposeSize < std::max(m_Width, m_Height))
+        m_TransposeSize *= 2;
+
+    m_Offsets.reserve(m_Width + m_Height + 1);
+    for (const auto* pHints : { &horizontalHints, &verticalHints })
+    {
+        // rows are as long as the width, columns as the height
+        int lineLength{ pHints == &horizontalHints ? m_Width : m_Height };
+
+        for (const std::vector<int>& hints : *pHints)
+        {
+            m_Offsets.push_back(uint16_t(m_Hints.size()));
+            for (int hint : hints)
+            {
+                // a hint that can't fit in its line can never be verified
+                if (hint < 0 || hint > lineLength)
+                {
+                    m_IsValid = false;
+                    return;
+                }
+                if (hint > 0) m_Hints.push_back(uint8_t(hint));
+            }
+        }
+    }
+    m_Offsets.push_back(uint16_t(m_Hints.size()));
+}
+
+bool SolutionVerifier::Verify(const uint64_t* pRows) const
+{
+    if (!m_IsValid) return false;
+
+    uint64_t columns[MaxSize];
+
+    for (int y = 0; y < m_Height; ++y)
+    {
+        uint64_t row{ pRows[y] };
+        if (row & ~m_RowMask || !VerifyLine(row, y)) return false;
+
+        columns[y] = row;
+    }
+    for (int y = m_Height; y < m_TransposeSize; ++y)
+        columns[y] = 0;
+
+    Transpose(columns, m_TransposeSize);
+
+    for (int x = 0; x < m_Width; ++x)
+    {
+        if (!VerifyLine(columns[x], m_Height + x)) return false;
+    }
+    return true;
+}
+
+void SolutionVerifier::VerifyBatch(const uint64_t* pGrids, size_t gridCount, bool* pResults, int threadCount) const
+{
+    threadCount = int(std::min(size_t(std::max(1, threadCount)), std::max(size_t(1), gridCount)));
+
+    auto verifyRange = [this, pGrids, pResults](size_t begin, size_t end)
+    {
+        for (size_t i{ begin }; i < end; ++i)
+            pResults[i] = Verify(pGrids + i * m_Height);
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+
+    // every thread gets its own consecutive range, the calling thread takes the last one
+    size_t rangeSize{ (gridCount + threadCount - 1) / threadCount };
+    for (int i = 0; i < threadCount - 1; ++i)
+        threads.emplace_back(verifyRange, std::min(gridCount, i * rangeSize), std::min(gridCount, (i + 1) * rangeSize));
+
+    verifyRange(std::min(gridCount, (threadCount - 1) * rangeSize), gridCount);
+
+    for (std::thread& thread : threads)
+        thread.join();
+}
+
+void SolutionVerifier::PackGrid(const std::vector<bool>& grid, uint64_t* pRows) const
+{
+    for (int y = 0; y < m_Height; ++y)
+    {
+        uint64_t row{};
+        for (int x = 0; x < m_Width; ++x)
+            if (grid[y * m_Width + x]) row |= 1ull << x;
+        pRows[y] = row;
+    }
+}
+
+bool SolutionVerifier::VerifyLine(uint64_t line, int lineIdx) const
+{
+    // a bit is set at the first square of every run and at the first empty square after it,
+    // split in two so the starts and the ends can be walked independently of each other
+    uint64_t boundaries{ line ^ (line << 1) };
+    uint64_t starts{ boundaries & line };
+    uint64_t ends{ boundaries & ~line };
+
+    const uint8_t* pHint{ m_Hints.data() + m_Offsets[lineIdx] };
+    const uint8_t* pHintEnd{ m_Hints.data() + m_Offsets[lineIdx + 1] };
+
+    while (starts)
+    {
+        // the end of a run that touches bit 63 got shifted out
+        int length{ (ends ? CountTrailingZeros(ends) : 64) - CountTrailingZeros(starts) };
+        starts &= starts - 1;
+        ends &= ends - 1;
+
+        if (pHint == pHintEnd || *pHint != length) return false;
+        ++pHint;
+    }
+    return pHint == pHintEnd;
+}
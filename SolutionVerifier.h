@@ -0,0 +1,54 @@
+#pragma once
+#include "Nonogram.h"
+#include <cstdint>
+#include <vector>
+
+// Checks submitted grids against the hints of a puzzle without allocating.
+//
+// A grid is packed as one 64 bit word per row where bit x is the square in column x,
+// so puzzles can be at most 64 squares wide and high.
+// The runs of every row are found with bit tricks: (row ^ (row << 1)) has a bit set at the start
+// of every run and right after its end, and counting the trailing zeros walks over those boundaries.
+// Columns get the same treatment after transposing the grid.
+class SolutionVerifier
+{
+public:
+
+    static constexpr int MaxSize{ 64 };
+
+    SolutionVerifier(const Nonogram& nonogram);
+    SolutionVerifier(const std::vector<std::vector<int>>& horizontalHints, const std::vector<std::vector<int>>& verticalHints);
+
+    // Returns true if the packed grid (GetHeight() words) matches every hint
+    bool Verify(const uint64_t* pRows) const;
+
+    // Verify gridCount packed grids that follow each other in memory, spread over threadCount threads
+    // pResults[i] is set to the result of grid i
+    void VerifyBatch(const uint64_t* pGrids, size_t gridCount, bool* pResults, int threadCount) const;
+
+    // Pack a grid as used by Nonogram into GetHeight() words
+    void PackGrid(const std::vector<bool>& grid, uint64_t* pRows) const;
+
+    // False when the puzzle is too big to be verified or has a hint that is negative or longer than its line
+    bool IsValid() const { return m_IsValid; }
+
+    int GetWidth() const { return m_Width; }
+    int GetHeight() const { return m_Height; }
+
+private:
+
+    // Compare the runs of a line with the hints from m_Hints[m_Offsets[lineIdx]] to m_Hints[m_Offsets[lineIdx + 1]]
+    bool VerifyLine(uint64_t line, int lineIdx) const;
+
+    // All row hints followed by all column hints, without the 0 hint of empty lines
+    std::vector<uint8_t> m_Hints;
+
+    // Where the hints of every line start, rows first, then columns. Has one extra entry at the end
+    std::vector<uint16_t> m_Offsets;
+
+    uint64_t m_RowMask{};
+    int m_TransposeSize{}; // smallest power of 2 that fits the width and the height
+    int m_Width{};
+    int m_Height{};
+    bool m_IsValid{};
+};